@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#include "batch.h"
+
+#include <cstdint>
+
+#include "common.h"
+#include "impl.h"
+
+namespace li {
+namespace {
+const int kLanes = 16;
+
+// cand is the candidate mask of a cell, fixed its digit bit once it is placed
+struct Lanes {
+  uint16_t cand[81][kLanes];
+  uint16_t fixed[81][kLanes];
+  uint16_t used[27][kLanes];
+  uint16_t bad[kLanes];
+  uint16_t placed[kLanes];
+  uint16_t left[kLanes];
+
+  void load(int l, const Array9i &puz) {
+    for (int pos = 0; pos < 81; pos++) {
+      int t = puz(pos / 9, pos % 9);
+      uint16_t bit = t > 0 && t < 10 ? 1 << t : 0;
+      cand[pos][l] = bit ? bit : kAllDigits;
+      fixed[pos][l] = bit;
+    }
+    bad[l] = 0;
+  }
+
+  // one round of eliminations, naked singles and hidden singles on every lane.
+  // The lane loops are branch free so that they compile to vector code.
+  void sweep() {
+    for (int l = 0; l < kLanes; l++) {
+      placed[l] = 0;
+      left[l] = 0;
+    }
+    for (int u = 0; u < 27; u++) {
+      uint16_t twice[kLanes];
+      for (int l = 0; l < kLanes; l++) {
+        used[u][l] = 0;
+        twice[l] = 0;
+      }
+      for (int pos : units.cell[u]) {
+        for (int l = 0; l < kLanes; l++) {
+          twice[l] |= used[u][l] & fixed[pos][l];
+          used[u][l] |= fixed[pos][l];
+        }
+      }
+      for (int l = 0; l < kLanes; l++) bad[l] |= twice[l];
+    }
+    for (int pos = 0; pos < 81; pos++) {
+      const int *un = units.unit[pos];
+      for (int l = 0; l < kLanes; l++) {
+        uint16_t fix = fixed[pos][l];
+        uint16_t open = -static_cast<uint16_t>(fix == 0);
+        uint16_t m = (cand[pos][l] & ~(used[un[0]][l] | used[un[1]][l] | used[un[2]][l]) & open) | fix;
+        uint16_t naked = open & -static_cast<uint16_t>(((m & (m - 1)) == 0) & (m != 0));
+        bad[l] |= m == 0;
+        placed[l] += naked & 1;
+        fixed[pos][l] = fix | (m & naked);
+        cand[pos][l] = m;
+      }
+    }
+    for (int u = 0; u < 27; u++) {
+      uint16_t once[kLanes], twice[kLanes], done[kLanes];
+      for (int l = 0; l < kLanes; l++) {
+        once[l] = twice[l] = done[l] = 0;
+      }
+      for (int pos : units.cell[u]) {
+        for (int l = 0; l < kLanes; l++) {
+          uint16_t fix = fixed[pos][l];
+          uint16_t m = cand[pos][l] & -static_cast<uint16_t>(fix == 0);
+          twice[l] |= once[l] & m;
+          once[l] |= m;
+          done[l] |= fix;
+        }
+      }
+      for (int l = 0; l < kLanes; l++) {
+        bad[l] |= (once[l] | done[l]) != kAllDigits;
+        once[l] &= ~twice[l] & ~done[l];
+      }
+      for (int pos : units.cell[u]) {
+        for (int l = 0; l < kLanes; l++) {
+          uint16_t fix = fixed[pos][l];
+          uint16_t h = cand[pos][l] & once[l] & -static_cast<uint16_t>(fix == 0);
+          uint16_t hit = -static_cast<uint16_t>(h != 0);
+          bad[l] |= h & (h - 1);
+          placed[l] += hit & 1;
+          fixed[pos][l] = fix | h;
+          cand[pos][l] = (cand[pos][l] & ~hit) | h;
+        }
+      }
+    }
+    for (int pos = 0; pos < 81; pos++) {
+      for (int l = 0; l < kLanes; l++) left[l] += fixed[pos][l] == 0;
+    }
+  }
+
+  void store(int l, Array9i board[]) const {
+    for (int pos = 0; pos < 81; pos++) {
+      uint16_t fix = fixed[pos][l];
+      board[0](pos / 9, pos % 9) = fix ? __builtin_ctz(fix) : 0;
+    }
+    init_note(board);
+  }
+};
+}  // namespace
+
+void rate_batch(const std::vector<Array9i> &puzzles, std::vector<int> &diffs) {
+  int n = puzzles.size();
+  diffs.assign(n, 0);
+  Lanes lanes;
+  int who[kLanes];
+  int next = 0, active = 0;
+  for (int l = 0; l < kLanes; l++) {
+    who[l] = -1;
+    lanes.load(l, puzzles.empty() ? Array9i::Zero() : puzzles[0]);
+  }
+  Array9i board[10];
+  std::vector<int> trace;
+  while (true) {
+    for (int l = 0; l < kLanes; l++) {
+      if (who[l] < 0 && next < n) {
+        who[l] = next++;
+        lanes.load(l, puzzles[who[l]]);
+        active++;
+      }
+    }
+    if (active == 0) break;
+    lanes.sweep();
+    for (int l = 0; l < kLanes; l++) {
+      if (who[l] < 0) continue;
+      if (lanes.bad[l]) {
+        diffs[who[l]] = 0;
+      } else if (lanes.left[l] == 0) {
+        diffs[who[l]] = 1;
+      } else if (lanes.placed[l] == 0) {
+        lanes.store(l, board);
+        trace.clear();
+        diffs[who[l]] = rate(board, trace);
+      } else {
+        continue;
+      }
+      who[l] = -1;
+      active--;
+    }
+  }
+}
+}  // namespace li
@@ -0,0 +1,27 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "config.h"
+
+namespace li {
+// Rates many puzzles at once. kLanes puzzles are laid out as a structure of
+// arrays, one 16-bit candidate mask per cell and lane, so a singles sweep
+// advances every lane with the same vector instructions. A lane leaves the
+// batch as soon as it is solved, contradicts itself or needs more than singles;
+// the next puzzle takes its place, and stuck puzzles go on with rate().
+// The result is the same as rating each puzzle alone, 0 for a contradiction.
+void rate_batch(const std::vector<Array9i> &puzzles, std::vector<int> &diffs);
+}  // namespace li
@@ -0,0 +1,83 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "impl.h"
+#include "sudoku.h"
+
+// builds origins for the same answers with several settings and minimizes them,
+// reporting origin size and time spent per difficulty
+
+using li::Array9i;
+using li::Difficulty;
+using li::Weight;
+
+const int times = 300;
+const int kLevel = 6;
+constexpr double kilo = 1000.0;
+
+void bench(const std::vector<Array9i> &answers, Difficulty dif, int seeds, int probe, const std::string &s) {
+  Array9i board[10], state[10];
+  std::vector<Weight> samp;
+  std::vector<int> trace;
+  double build = 0, minimize = 0;
+  long origin = 0, givens = 0;
+  int a[kLevel] = {0};
+  li::Random rng(1);
+  for (auto &ans : answers) {
+    auto t1 = std::chrono::steady_clock::now();
+    li::build_origin(ans, seeds, probe, board, samp, rng);
+    auto t2 = std::chrono::steady_clock::now();
+    origin += samp.size();
+    bool saved;
+    switch (dif) {
+      case Difficulty::easy:
+        saved = li::always_easy(samp, ans, state);
+        break;
+      case Difficulty::medium:
+        saved = li::often_medium(samp, ans, rng, nullptr, state);
+        break;
+      default:
+        saved = li::usually_hard(samp, ans, rng, nullptr, state);
+        break;
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    build += std::chrono::duration<double>(t2 - t1).count();
+    minimize += std::chrono::duration<double>(t3 - t2).count();
+    givens += samp.size();
+    if (!saved) {
+      state[0].fill(0);
+      for (auto &ele : samp) state[0](ele.r, ele.c) = ans(ele.r, ele.c);
+      li::init_note(state);
+    }
+    trace.clear();
+    a[li::rate(state, trace)]++;
+  }
+  std::cout << s << ": " << static_cast<double>(origin) / times << " origin clues, " << kilo * build / times
+            << "ms build, " << kilo * minimize / times << "ms minimize, " << static_cast<double>(givens) / times
+            << " givens left, levels";
+  for (int i = 1; i < kLevel; i++) std::cout << " " << a[i];
+  std::cout << std::endl;
+}
+
+int main() {
+  li::Sudoku game(1);
+  std::vector<Array9i> answers;
+  for (int i = 0; i < times; i++) {
+    game.newGame(Difficulty::easy);
+    answers.push_back(game.getGame().answer);
+  }
+
+  const Difficulty difs[] = {Difficulty::easy, Difficulty::medium, Difficulty::hard};
+  const char *names[] = {"easy", "medium", "hard"};
+  const int settings[][2] = {{30, 0}, {30, 8}, {15, 8}, {0, 8}, {0, 81}};
+  for (int k = 0; k < 3; k++) {
+    for (auto &set : settings) {
+      bench(answers, difs[k], set[0], set[1],
+            std::string(names[k]) + ", seeds " + std::to_string(set[0]) + ", probe " + std::to_string(set[1]));
+    }
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,72 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "pattern.h"
+#include "solver.h"
+#include "sudoku.h"
+
+// generates games whose givens follow a fixed mask, per pattern and difficulty
+
+using li::Array9i;
+using li::Difficulty;
+using li::Givens;
+
+const int times = 200;
+const int games = 20;
+
+// diagonals crossing every block
+const char *custom =
+    "x...x...x"
+    ".x.x.x.x."
+    "..x...x.."
+    ".x.....x."
+    "x..xxx..x"
+    ".x.....x."
+    "..x...x.."
+    ".x.x.x.x."
+    "x...x...x";
+
+// unique and with givens on exactly the masked cells
+bool check(const Array9i &puz, const Givens &mask) {
+  for (int pos = 0; pos < 81; pos++) {
+    if ((puz(pos / 9, pos % 9) > 0) != mask[pos]) return false;
+  }
+  li::Solver sol(puz);
+  sol.setLimit(1);
+  return sol.run() == 1;
+}
+
+void bench(li::Sudoku &game, li::Random &rng, const Givens &mask, const std::string &s) {
+  Array9i puz, ans;
+  int good = 0;
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < times; i++) {
+    if (li::fit_givens(mask, puz, ans, rng)) good += check(puz, mask);
+  }
+  std::chrono::duration<double> t2 = std::chrono::steady_clock::now() - t1;
+  std::cout << s << ", " << mask.count() << " givens: " << good << "/" << times << " fitted, "
+            << times / t2.count() << " puzzles/s" << std::endl;
+
+  const Difficulty difs[] = {Difficulty::easy, Difficulty::medium, Difficulty::hard};
+  const char *names[] = {"easy", "medium", "hard"};
+  for (int k = 0; k < 3; k++) {
+    int found = 0;
+    t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < games; i++) {
+      if (game.newGame(difs[k], mask, 20)) found += check(game.getGame().puzzle, mask);
+    }
+    t2 = std::chrono::steady_clock::now() - t1;
+    std::cout << "  " << names[k] << ": " << found << "/" << games << " found, " << games / t2.count()
+              << " games/s" << std::endl;
+  }
+}
+
+int main() {
+  li::Sudoku game(1);
+  li::Random rng(1);
+  bench(game, rng, li::random_givens(30, li::Symmetry::rotational, rng), "rotational");
+  bench(game, rng, li::random_givens(30, li::Symmetry::mirror, rng), "mirror");
+  bench(game, rng, li::random_givens(30, li::Symmetry::diagonal, rng), "diagonal");
+  bench(game, rng, li::parse_givens(custom), "custom");
+}
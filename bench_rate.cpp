@@ -0,0 +1,73 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "batch.h"
+#include "common.h"
+#include "impl.h"
+#include "sudoku.h"
+#include "technique.h"
+
+// rates the same generated games one by one and in batches, and checks they agree
+
+using li::Array9i;
+using li::Difficulty;
+
+const int times = 2000;
+const int rounds = 10;
+const int kLevel = 6;
+
+int main() {
+  li::Sudoku game(1);
+  std::vector<Array9i> puzzles;
+  std::vector<int> expect;
+  const Difficulty difs[] = {Difficulty::easy, Difficulty::medium, Difficulty::hard};
+  for (int i = 0; i < times; i++) {
+    expect.push_back(game.newGame(difs[i % 3]));
+    puzzles.push_back(game.getGame().puzzle);
+  }
+
+  Array9i board[10];
+  std::vector<int> trace, one(times), many;
+  auto t1 = std::chrono::steady_clock::now();
+  for (int k = 0; k < rounds; k++) {
+    for (int i = 0; i < times; i++) {
+      board[0] = puzzles[i];
+      li::init_note(board);
+      trace.clear();
+      one[i] = li::rate(board, trace);
+    }
+  }
+  std::chrono::duration<double> t2 = std::chrono::steady_clock::now() - t1;
+  std::cout << "one by one: " << times * rounds / t2.count() << " puzzles/s" << std::endl;
+
+  t1 = std::chrono::steady_clock::now();
+  for (int k = 0; k < rounds; k++) {
+    li::rate_batch(puzzles, many);
+  }
+  t2 = std::chrono::steady_clock::now() - t1;
+  std::cout << "batch: " << times * rounds / t2.count() << " puzzles/s" << std::endl;
+
+  int a[kLevel] = {0}, diff = 0;
+  for (int i = 0; i < times; i++) {
+    a[many[i]]++;
+    diff += one[i] != expect[i] || many[i] != expect[i];
+  }
+  for (int i = 1; i < kLevel; i++) std::cout << a[i] << " ";
+  std::cout << std::endl << diff << " differ" << std::endl;
+
+  li::Scheduler sched;
+  sched.setTiming(true);
+  for (int i = 0; i < times; i++) {
+    board[0] = puzzles[i];
+    li::init_note(board);
+    trace.clear();
+    sched.rate(board, trace);
+  }
+  for (size_t i = 0; i < sched.techniques().size(); i++) {
+    auto &tech = sched.techniques()[i];
+    auto &stat = sched.stats()[i];
+    std::cout << tech.name << ": " << stat.calls << " calls, " << stat.hits << " hits, "
+              << (stat.calls ? stat.seconds / stat.calls * 1e6 : 0) << " us/call" << std::endl;
+  }
+}
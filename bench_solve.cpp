@@ -0,0 +1,89 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "race.h"
+#include "solver.h"
+#include "sudoku.h"
+
+// usage: bench_solve [file ...]
+// each line of a file holds one puzzle as 81 characters, blanks as '0' or '.'
+// without files, games of every level generated here and a few well-known hard ones are used
+
+using li::Array9i;
+
+const int times = 1000;
+const int rounds = 10;
+
+const char *hardest[] = {
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+    "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..",
+    "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9",
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+    "52...6.........7.13...........4..8..6......5...........418.........3..2...87.....",
+    "6.....8.3.4.7.................5.4.7.3..2.....1.6.......2.....5.....8.6......1....",
+};
+
+bool parse(const std::string &line, Array9i &puz) {
+  if (line.size() < 81) return false;
+  for (int i = 0; i < 81; i++) {
+    char ch = line[i];
+    if (ch >= '1' && ch <= '9') {
+      puz(i / 9, i % 9) = ch - '0';
+    } else if (ch == '0' || ch == '.') {
+      puz(i / 9, i % 9) = 0;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void bench(const std::string &s, const std::vector<Array9i> &puzzles) {
+  if (puzzles.empty()) return;
+  int solved = 0, unique = 0;
+  auto t1 = std::chrono::steady_clock::now();
+  for (int k = 0; k < rounds; k++) {
+    for (auto &puz : puzzles) {
+      li::Solver sol(puz);
+      sol.setLimit(1);
+      int n = sol.run();
+      solved += n > 0;
+      unique += n == 1;
+    }
+  }
+  std::chrono::duration<double> t2 = std::chrono::steady_clock::now() - t1;
+  std::cout << s << ": " << puzzles.size() << " puzzles, " << solved / rounds << " solved, " << unique / rounds
+            << " unique, " << puzzles.size() * rounds / t2.count() << " puzzles/s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  Array9i puz;
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      std::ifstream in(argv[i]);
+      std::vector<Array9i> puzzles;
+      for (std::string line; std::getline(in, line);) {
+        if (parse(line, puz)) puzzles.push_back(puz);
+      }
+      bench(argv[i], puzzles);
+    }
+    return 0;
+  }
+
+  li::Sudoku game(1);
+  for (int level = 1; level < 6; level++) {
+    std::vector<Array9i> puzzles;
+    for (int i = 0; puzzles.size() < times / 10 && i < times; i++) {
+      if (game.newGame(li::strategy(level)) == level) puzzles.push_back(game.getGame().puzzle);
+    }
+    bench("level " + std::to_string(level), puzzles);
+  }
+  std::vector<Array9i> puzzles;
+  for (auto line : hardest) {
+    if (parse(line, puz)) puzzles.push_back(puz);
+  }
+  bench("hardest", puzzles);
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#include "bulk.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "parallel.h"
+#include "race.h"
+
+namespace li {
+namespace {
+const size_t kQueue = 1024;
+const size_t kBlock = 1 << 20;
+
+void append_grid(const Array9i &grid, std::string &buf) {
+  for (int r = 0; r < 9; r++) {
+    for (int c = 0; c < 9; c++) {
+      buf += static_cast<char>('0' + grid(r, c));
+    }
+  }
+}
+
+void append_bytes(const Array9i &grid, std::string &buf) {
+  for (int r = 0; r < 9; r++) {
+    for (int c = 0; c < 9; c++) {
+      buf += static_cast<char>(grid(r, c));
+    }
+  }
+}
+}  // namespace
+
+void format_record(const Record &rec, Format fmt, std::string &buf) {
+  switch (fmt) {
+    case Format::text:
+      append_grid(rec.game.puzzle, buf);
+      buf += ' ';
+      append_grid(rec.game.answer, buf);
+      buf += ' ' + std::to_string(rec.game.diff) + ' ' + std::to_string(rec.seed) + '\n';
+      break;
+    case Format::ndjson:
+      buf += "{\"puzzle\":\"";
+      append_grid(rec.game.puzzle, buf);
+      buf += "\",\"solution\":\"";
+      append_grid(rec.game.answer, buf);
+      buf += "\",\"rating\":" + std::to_string(rec.game.diff) + ",\"seed\":" + std::to_string(rec.seed) + "}\n";
+      break;
+    case Format::binary:
+      append_bytes(rec.game.puzzle, buf);
+      append_bytes(rec.game.answer, buf);
+      buf += static_cast<char>(rec.game.diff);
+      for (int i = 0; i < 4; i++) {
+        buf += static_cast<char>(rec.seed >> 8 * i & 0xff);
+      }
+      break;
+  }
+}
+
+bool bulk_export(std::FILE *out, int count, int level, int threads, Format fmt, unsigned seed, size_t &bytes) {
+  if (threads < 1) threads = 1;
+  BoundedQueue<Record> queue(kQueue);
+  std::atomic<int> taken(0);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; i++) {
+    workers.emplace_back([&, i] {
+      Sudoku game;
+      Record rec;
+      for (unsigned s = seed + i; taken < count; s += threads) {
+        // the same game as Sudoku(s) would make
+        game.setSeed(s);
+        if (game.newGame(strategy(level)) != level) continue;
+        if (taken++ >= count) break;
+        rec.game = game.getGame();
+        rec.seed = s;
+        // closed when the writer failed
+        if (!queue.push(rec)) break;
+      }
+    });
+  }
+
+  bytes = 0;
+  bool good = true;
+  std::thread writer([&] {
+    std::string buf;
+    buf.reserve(kBlock + 512);
+    Record rec;
+    auto flush = [&] {
+      size_t n = std::fwrite(buf.data(), 1, buf.size(), out);
+      bool whole = n == buf.size();
+      bytes += n;
+      buf.clear();
+      return whole;
+    };
+    while (good && queue.pop(rec)) {
+      format_record(rec, fmt, buf);
+      if (buf.size() >= kBlock) good = flush();
+    }
+    if (good) good = flush() && std::fflush(out) == 0 && !std::ferror(out);
+    if (!good) queue.close();
+  });
+
+  for (auto &th : workers) {
+    th.join();
+  }
+  queue.close();
+  writer.join();
+  return good;
+}
+}  // namespace li
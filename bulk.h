@@ -0,0 +1,41 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "sudoku.h"
+
+namespace li {
+enum class Format { text, binary, ndjson };
+
+// Sudoku(seed).newGame(strategy(game.diff)) makes the game again
+struct Record {
+  Game game;
+  unsigned seed;
+};
+
+// Appends one record to buf:
+// text    81 givens, 81 answer digits, rating and seed on one line, blanks as 0
+// ndjson  {"puzzle":"...","solution":"...","rating":r,"seed":s}
+// binary  81 + 81 bytes of digits, 1 byte rating, 4 bytes seed little endian
+void format_record(const Record &rec, Format fmt, std::string &buf);
+
+// Generates count games rated level on threads threads and writes them to out
+// from one writer thread, in large blocks. Thread i tries the seeds
+// seed + i, seed + i + threads, ...; the order of the records depends on timing.
+// bytes is set to the number of bytes written. Returns false if writing to out
+// failed, in which case generation stops early.
+bool bulk_export(std::FILE *out, int count, int level, int threads, Format fmt, unsigned seed, size_t &bytes);
+}  // namespace li
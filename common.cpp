@@ -12,10 +12,36 @@
  */
 #include "common.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <tuple>
 
 namespace li {
+Units::Units() {
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 9; j++) {
+      cell[i][j] = i * 9 + j;
+      cell[9 + i][j] = j * 9 + i;
+      cell[18 + i][j] = (i / 3 * 3 + j / 3) * 9 + i % 3 * 3 + j % 3;
+    }
+  }
+  for (int pos = 0; pos < 81; pos++) {
+    int r = pos / 9, c = pos % 9, n = 0;
+    unit[pos][0] = r;
+    unit[pos][1] = 9 + c;
+    unit[pos][2] = 18 + r / 3 * 3 + c / 3;
+    for (int other = 0; other < 81; other++) {
+      int i = other / 9, j = other % 9;
+      if (other != pos && (i == r || j == c || (i / 3 == r / 3 && j / 3 == c / 3))) {
+        peer[pos][n++] = other;
+      }
+    }
+  }
+}
+
+const Units units;
+
 namespace {
 Array9i get_notes(const Array9i board[]) {
   Array9i notes;
@@ -28,6 +54,165 @@ Array9i get_notes(const Array9i board[]) {
 }
 
 inline bool single_bit(int n) { return n > 0 && !(n & (n - 1)); }
+
+// the cell of pos in the other numbering, r * 9 + c <-> c * 9 + r
+inline int flip(int pos) { return pos % 9 * 9 + pos / 9; }
+
+// units with the cells numbered by their offset in the column-major storage of
+// Array9i, for the worklist
+struct ColUnits {
+  int cell[27][9];
+  int unit[81][3];
+  int peer[81][20];
+  // spread[m >> 1] gives one 4-bit counter per digit of the notes m
+  uint64_t spread[512];
+  ColUnits() {
+    for (int u = 0; u < 27; u++) {
+      for (int j = 0; j < 9; j++) {
+        cell[u][j] = flip(units.cell[u][j]);
+      }
+    }
+    for (int pos = 0; pos < 81; pos++) {
+      for (int k = 0; k < 3; k++) {
+        unit[pos][k] = units.unit[flip(pos)][k];
+      }
+      for (int k = 0; k < 20; k++) {
+        peer[pos][k] = flip(units.peer[flip(pos)][k]);
+      }
+      std::sort(peer[pos], peer[pos] + 20);
+    }
+    for (int m = 0; m < 512; m++) {
+      spread[m] = 0;
+      for (int k = 0; k < 9; k++) {
+        spread[m] |= static_cast<uint64_t>(m >> k & 1) << 4 * k;
+      }
+    }
+  }
+};
+
+const ColUnits cols;
+
+// Singles propagation driven by the candidates removed by each placement.
+// It counts the candidates of every digit in every unit (4 bits per digit)
+// and of every cell once, then only units and cells that drop to one
+// candidate are looked at again, instead of rescanning all nine planes after
+// each placement.
+class Worklist {
+ public:
+  Worklist(Array9i board[], bool check) : _board(board), _check(check), _bad(false), _un(0), _cn(0) {
+    const int *val = board[0].data();
+    Array9i notes = get_notes(board);
+    for (int pos = 0; pos < 81; pos++) {
+      _notes[pos] = notes(pos);
+    }
+    for (int u = 0; u < 27; u++) {
+      _count[u] = 0;
+      _fixed[u] = 0;
+    }
+    for (int pos = 0; pos < 81; pos++) {
+      uint64_t cnt = cols.spread[_notes[pos] >> 1 & 511];
+      int t = val[pos];
+      int fix = t > 0 && t < 10 ? 1 << t : 0;
+      for (int u : cols.unit[pos]) {
+        _count[u] += cnt;
+        _fixed[u] |= fix;
+      }
+    }
+    const uint64_t high = 0xeeeeeeeeeull, low = 0x222222222ull;
+    for (int u = 0; u < 27; u++) {
+      // digits not yet placed in the unit with at most one candidate left
+      uint64_t t = _count[u] & high;
+      uint64_t open = ~(cols.spread[_fixed[u] >> 1] << 1);
+      for (uint64_t m = ~(t | t >> 1 | t >> 2) & low & open; m; m &= m - 1) {
+        check_unit(__builtin_ctzll(m) / 4 + 1, u);
+      }
+    }
+    for (int pos = 0; pos < 81; pos++) {
+      if (val[pos] <= 0 && at_most_one(_notes[pos])) check_cell(pos);
+    }
+  }
+
+  bool bad() const { return _bad; }
+
+  // finds the next single, false when there is none left or a contradiction was found
+  bool next(int &pos, int &num) {
+    while (!_bad && (_un > 0 || _cn > 0)) {
+      if (_un > 0) {
+        int k = _us[--_un] / 27, u = _us[_un] % 27;
+        if ((_fixed[u] >> k & 1) || count(k, u) != 1) continue;
+        int at = 0;
+        for (int p : cols.cell[u]) {
+          if (_notes[p] >> k & 1) at = p;
+        }
+        pos = at;
+        num = k;
+        return true;
+      } else {
+        pos = _cs[--_cn];
+        if (_board[0].data()[pos] > 0 || !single_bit(_notes[pos])) continue;
+        num = __builtin_ctz(_notes[pos]);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // set_num, following the candidates it removes
+  void place(int pos, int num) {
+    _board[0].data()[pos] = num;
+    for (int u : cols.unit[pos]) _fixed[u] |= 1 << num;
+    for (int m = _notes[pos]; m; m &= m - 1) {
+      remove(__builtin_ctz(m), pos);
+    }
+    for (int p : cols.peer[pos]) {
+      if (_notes[p] >> num & 1) remove(num, p);
+    }
+  }
+
+ private:
+  int count(int k, int u) const { return _count[u] >> 4 * (k - 1) & 15; }
+
+  void remove(int k, int pos) {
+    _board[k].data()[pos] = 0;
+    _notes[pos] &= ~(1 << k);
+    for (int u : cols.unit[pos]) {
+      _count[u] -= 1ull << 4 * (k - 1);
+      if (count(k, u) <= 1) check_unit(k, u);
+    }
+    if (_board[0].data()[pos] <= 0 && at_most_one(_notes[pos])) check_cell(pos);
+  }
+
+  void check_unit(int k, int u) {
+    if (_fixed[u] >> k & 1) return;
+    if (count(k, u) == 1) {
+      _us[_un++] = k * 27 + u;
+    } else if (_check) {
+      _bad = true;
+    }
+  }
+
+  void check_cell(int pos) {
+    if (_notes[pos]) {
+      _cs[_cn++] = pos;
+    } else if (_check) {
+      _bad = true;
+    }
+  }
+
+  static bool at_most_one(int n) { return !(n & (n - 1)); }
+
+  Array9i *_board;
+  bool _check;
+  bool _bad;
+  // separate types from the int planes, so writing a plane doesn't force reloads
+  uint16_t _notes[81];
+  uint64_t _count[27];
+  uint16_t _fixed[27];
+  int _us[270 * 2];
+  int _cs[81 * 2];
+  int _un;
+  int _cn;
+};
 }  // namespace
 
 bool operator<(const Weight &a, const Weight &b) { return std::tie(a.w, a.hash) < std::tie(b.w, b.hash); }
@@ -135,23 +320,13 @@ void set_num(int r, int c, int num, Array9i board[]) {
 }
 
 int fill_all_single(Array9i board[], bool check) {
-  int r, c, num;
-  if (!get_single(r, c, num, board)) {
-    return 0;
-  }
-
-  for (; num > 0; get_single(r, c, num, board)) {
-    do {
-      set_num(r, c, num, board);
-    } while (row_single(r, c, board[num]) || col_single(r, c, board[num]));
-
-    if (check) {
-      Array9i cur = board[num] + (board[0] == num).cast<int>();
-      if ((cur.colwise().sum() == 0).any() || (cur.rowwise().sum() == 0).any() || block_sum_0(cur)) {
-        return -1;
-      }
-    }
+  Worklist work(board, check);
+  int res = 0;
+  int pos, num;
+  while (work.next(pos, num)) {
+    work.place(pos, num);
+    res = 1;
   }
-  return 1;
+  return work.bad() ? -1 : res;
 }
 }  // namespace li
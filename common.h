@@ -15,6 +15,20 @@
 #include "config.h"
 
 namespace li {
+// Digit n is bit n of a digit mask.
+const int kAllDigits = 0x3fe;
+
+// Cells are numbered r * 9 + c. Units are the rows 0..8, the cols 9..17 and
+// the blocks 18..26.
+struct Units {
+  int cell[27][9];
+  int unit[81][3];
+  int peer[81][20];
+  Units();
+};
+
+extern const Units units;
+
 bool operator<(const Weight &a, const Weight &b);
 
 bool block_sum_0(const Array9i &arr);
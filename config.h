@@ -13,9 +13,12 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <random>
 
 namespace li {
 using Array9i = Eigen::Array<int, 9, 9>;
+// the random engine of one Sudoku, passed to everything that draws from it
+using Random = std::minstd_rand;
 
 struct Weight {
   int r;
@@ -1,8 +1,25 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <iostream>
+#include <string>
 
+#include "bulk.h"
 #include "sudoku.h"
 
-int main() {
+// usage: quickSudoku [--count N] [--level L] [--threads T] [--format text|binary|ndjson] [--out file] [--seed S]
+// without options, prints one medium puzzle
+
+int usage() {
+  std::cerr << "usage: quickSudoku [--count N] [--level 1-5] [--threads T] [--format text|binary|ndjson] "
+               "[--out file] [--seed S]"
+            << std::endl;
+  return 1;
+}
+
+int print_one() {
   int num;
   li::Sudoku game;
   using li::Difficulty;
@@ -17,4 +34,63 @@ int main() {
     }
     std::cout << std::endl;
   }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 1) return print_one();
+
+  int count = 1, level = 3, threads = 1;
+  unsigned seed = time(0);
+  li::Format fmt = li::Format::text;
+  std::string out;
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 == argc) return usage();
+    const char *arg = argv[i], *val = argv[++i];
+    if (!strcmp(arg, "--count")) {
+      count = atoi(val);
+    } else if (!strcmp(arg, "--level")) {
+      level = atoi(val);
+    } else if (!strcmp(arg, "--threads")) {
+      threads = atoi(val);
+    } else if (!strcmp(arg, "--seed")) {
+      seed = strtoul(val, nullptr, 10);
+    } else if (!strcmp(arg, "--out")) {
+      out = val;
+    } else if (!strcmp(arg, "--format")) {
+      if (!strcmp(val, "text")) {
+        fmt = li::Format::text;
+      } else if (!strcmp(val, "binary")) {
+        fmt = li::Format::binary;
+      } else if (!strcmp(val, "ndjson")) {
+        fmt = li::Format::ndjson;
+      } else {
+        return usage();
+      }
+    } else {
+      return usage();
+    }
+  }
+  if (count < 0 || level < 1 || level > 5 || threads < 1) return usage();
+
+  std::FILE *file = stdout;
+  if (!out.empty() && out != "-") {
+    file = std::fopen(out.c_str(), "wb");
+    if (!file) {
+      std::perror(out.c_str());
+      return 1;
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  size_t bytes;
+  bool good = li::bulk_export(file, count, level, threads, fmt, seed, bytes);
+  std::chrono::duration<double> t2 = std::chrono::steady_clock::now() - t1;
+  if (file != stdout && std::fclose(file) != 0) good = false;
+  if (!good) {
+    std::cerr << (file == stdout ? "stdout" : out) << ": write failed" << std::endl;
+    return 1;
+  }
+  std::cerr << count << " puzzles in " << t2.count() << " s, " << count / t2.count() << " puzzles/s, " << bytes
+            << " bytes written" << std::endl;
+  return 0;
 }
@@ -12,8 +12,13 @@
  */
 #include "impl.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "common.h"
 #include "dfs.h"
+#include "parallel.h"
+#include "technique.h"
 
 namespace li {
 namespace {
@@ -26,39 +31,69 @@ int count_notes(int r, int c, const Array9i board[]) {
   return res;
 }
 
-void update_diff(std::vector<Weight> &samp, const Array9i &ans) {
+struct Board {
+  Array9i plane[10];
+};
+
+void copy_board(Array9i dst[], const Array9i src[]) {
+  for (int i = 0; i < 10; i++) {
+    dst[i] = src[i];
+  }
+}
+
+// board is left at the singles fixpoint of the givens without wt
+void eval_clue(Weight &wt, const Array9i &bak, const Array9i &ans, Array9i board[]) {
+  board[0] = bak;
+  int cur_r = wt.r;
+  int cur_c = wt.c;
+  board[0](cur_r, cur_c) = 0;
+  init_note(board);
+  fill_all_single(board);
+
+  if (!board[0](cur_r, cur_c)) {
+    wt.w = 2;
+    for (int j = 1; j < 10; ++j)
+      if (board[j](cur_r, cur_c) && j != ans(cur_r, cur_c)) {
+        bool isFind = false;
+        dfsDeduce(cur_r, cur_c, j, board, isFind);
+        if (isFind) {
+          wt.w = -1;
+          break;
+        }
+      }
+  }
+}
+
+void update_diff(std::vector<Weight> &samp, const Array9i &ans, Random &rng, ThreadPool *pool,
+                 std::vector<Board> &boards) {
   Array9i bak;
-  Array9i board[10];
   bak.fill(0);
   for (auto &ele : samp) {
     bak(ele.r, ele.c) = ans(ele.r, ele.c);
   }
+  // hashes are drawn up front, so the parallel path consumes rng exactly like the serial one
+  std::vector<int> todo;
   for (int i = samp.size() - 1; i >= 0; i--)
     if (samp[i].w > 0) {
-      board[0] = bak;
-      int cur_r = samp[i].r;
-      int cur_c = samp[i].c;
-      board[0](cur_r, cur_c) = 0;
-      init_note(board);
-      fill_all_single(board);
-
-      samp[i].hash = rand();
-      if (!board[0](cur_r, cur_c)) {
-        samp[i].w = 2;
-        for (int j = 1; j < 10; ++j)
-          if (board[j](cur_r, cur_c) && j != ans(cur_r, cur_c)) {
-            bool isFind = false;
-            dfsDeduce(cur_r, cur_c, j, board, isFind);
-            if (isFind) {
-              samp[i].w = -1;
-              break;
-            }
-          }
-      }
+      samp[i].hash = rng();
+      todo.push_back(i);
+    }
+  boards.resize(samp.size());
+  if (pool) {
+    pool->parallel_for(todo.size(), [&](int idx, int) {
+      int i = todo[idx];
+      eval_clue(samp[i], bak, ans, boards[i].plane);
+    });
+  } else {
+    for (int i : todo) {
+      eval_clue(samp[i], bak, ans, boards[i].plane);
     }
+  }
 }
 
-void erase_easy(std::vector<Weight> &samp, const Array9i &ans) {
+// every erase leaves board at the singles fixpoint of the remaining givens
+bool erase_easy(std::vector<Weight> &samp, const Array9i &ans, Array9i state[]) {
+  bool saved = false;
   Array9i bak;
   Array9i board[10];
   bak.fill(0);
@@ -77,8 +112,11 @@ void erase_easy(std::vector<Weight> &samp, const Array9i &ans) {
       if (board[0](cur_r, cur_c)) {
         bak(cur_r, cur_c) = 0;
         samp.erase(samp.begin() + i);
+        if (state) copy_board(state, board);
+        saved = true;
       }
     }
+  return saved;
 }
 
 struct Point {
@@ -121,39 +159,103 @@ std::vector<Point> note_remove(const Array9i &asp, bool once, bool cons_block =
 }
 }  // namespace
 
-bool filter_notes(const Array9i board[], std::vector<Weight> &vec) {
+bool filter_notes(const Array9i board[], std::vector<Weight> &vec, Random &rng) {
   vec.clear();
   for (int i = 0; i < 9; i++) {
     for (int j = 0; j < 9; j++) {
       int n = board[0](i, j);
       if (n <= 0) {
-        vec.push_back({i, j, count_notes(i, j, board), rand()});
+        vec.push_back({i, j, count_notes(i, j, board), static_cast<int>(rng())});
       }
     }
   }
   return !vec.empty();
 }
 
-void always_easy(std::vector<Weight> &samp, const Array9i &ans) { erase_easy(samp, ans); }
+void build_origin(const Array9i &ans, int seeds, int probe, Array9i board[], std::vector<Weight> &samp, Random &rng) {
+  std::vector<int> pool(81);
+  std::iota(pool.begin(), pool.end(), 0);
+  int limit = pool.size();
 
-void often_medium(std::vector<Weight> &samp, const Array9i &ans) {
+  samp.clear();
+  board[0].fill(0);
+  for (int i = 0; i < seeds && limit > 0; i++) {
+    int n = rng() % limit;
+    int pos = pool[n];
+    std::swap(pool[n], pool[--limit]);
+    int r = pos / 9;
+    int c = pos % 9;
+    board[0](r, c) = ans(r, c);
+    samp.push_back({r, c, 1});
+  }
+  init_note(board);
+
+  std::vector<Weight> vec;
+  Array9i scratch[10];
+  while (board[0].minCoeff() <= 0) {
+    fill_all_single(board);
+    if (!filter_notes(board, vec, rng)) break;
+    auto it = std::max_element(vec.begin(), vec.end());
+    if (probe > 0) {
+      // the candidates left after placing each of the probe fullest cells
+      int k = std::min<int>(probe, vec.size());
+      std::partial_sort(vec.begin(), vec.begin() + k, vec.end(), [](const Weight &a, const Weight &b) { return b < a; });
+      int fewest = -1;
+      for (int i = 0; i < k; i++) {
+        copy_board(scratch, board);
+        set_num(vec[i].r, vec[i].c, ans(vec[i].r, vec[i].c), scratch);
+        fill_all_single(scratch);
+        int left = 0;
+        for (int n = 1; n < 10; n++) {
+          left += scratch[n].sum();
+        }
+        if (fewest < 0 || left < fewest) {
+          fewest = left;
+          it = vec.begin() + i;
+        }
+      }
+    }
+    set_num(it->r, it->c, ans(it->r, it->c), board);
+    samp.push_back({it->r, it->c, 1});
+  }
+}
+
+bool always_easy(std::vector<Weight> &samp, const Array9i &ans, Array9i state[]) {
+  return erase_easy(samp, ans, state);
+}
+
+bool often_medium(std::vector<Weight> &samp, const Array9i &ans, Random &rng, ThreadPool *pool, Array9i state[]) {
+  bool saved = false;
+  std::vector<Board> boards;
   while (std::any_of(samp.begin(), samp.end(), [](const Weight &wt) { return wt.w > 0; })) {
-    update_diff(samp, ans);
+    update_diff(samp, ans, rng, pool, boards);
     auto it = max_element(samp.begin(), samp.end());
     int w = it->w;
+    // the last candidates may have just turned into anchors
+    if (w < 0) break;
+    if (state) copy_board(state, boards[it - samp.begin()].plane);
+    saved = true;
     samp.erase(it);
     if (w > 1) {
       break;
     }
   }
-  erase_easy(samp, ans);
+  return erase_easy(samp, ans, state) || saved;
 }
 
-void usually_hard(std::vector<Weight> &samp, const Array9i &ans) {
+bool usually_hard(std::vector<Weight> &samp, const Array9i &ans, Random &rng, ThreadPool *pool, Array9i state[]) {
+  bool saved = false;
+  std::vector<Board> boards;
   while (std::any_of(samp.begin(), samp.end(), [](const Weight &wt) { return wt.w > 0; })) {
-    update_diff(samp, ans);
-    samp.erase(max_element(samp.begin(), samp.end()));
+    update_diff(samp, ans, rng, pool, boards);
+    auto it = max_element(samp.begin(), samp.end());
+    if (it->w > 0) {
+      if (state) copy_board(state, boards[it - samp.begin()].plane);
+      saved = true;
+      samp.erase(it);
+    }
   }
+  return saved;
 }
 
 void col_swap_block(int &r, int &c) {
@@ -165,11 +267,12 @@ void col_swap_block(int &r, int &c) {
   r = e * 3 + d;
 }
 
-bool _remove(Array9i board[], bool once) {
+bool _remove(Array9i board[], bool once, int digits) {
   bool modify = false;
   std::vector<Point> vec;
   Array9i asp;
   for (int n = 1; n < 10; n++) {
+    if (!(digits >> n & 1)) continue;
     asp = (board[0] == n).cast<int>() * 10 + board[n];
     vec = note_remove(asp, once);
     if (!vec.empty()) modify = true;
@@ -216,4 +319,13 @@ bool col_circle_remove(Array9i board[], void (*fun)(int &, int &)) {
   }
   return modify;
 }
+
+bool circle_remove(Array9i board[]) {
+  return col_circle_remove(board) | col_circle_remove(board, std::swap<int>) | col_circle_remove(board, col_swap_block);
+}
+
+int rate(Array9i board[], std::vector<int> &trace) {
+  thread_local Scheduler sched;
+  return sched.rate(board, trace);
+}
 }  // namespace li
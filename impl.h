@@ -14,16 +14,35 @@
 
 #include <vector>
 
+#include "common.h"
 #include "config.h"
 
 namespace li {
-bool filter_notes(const Array9i board[], std::vector<Weight> &vec);
+class ThreadPool;
 
-void always_easy(std::vector<Weight> &samp, const Array9i &ans);
-void often_medium(std::vector<Weight> &samp, const Array9i &ans);
-void usually_hard(std::vector<Weight> &samp, const Array9i &ans);
+bool filter_notes(const Array9i board[], std::vector<Weight> &vec, Random &rng);
+
+// Givens of ans to minimize from: seeds random cells, then one cell at a time
+// until singles solve the board. With probe = 0 the added cell is the one with
+// the most candidates; otherwise each of the probe cells with the most
+// candidates is placed on a scratch board, and the one whose singles leave the
+// fewest candidates is added. board ends up solved.
+void build_origin(const Array9i &ans, int seeds, int probe, Array9i board[], std::vector<Weight> &samp, Random &rng);
+
+// pool spreads the clue evaluation across threads; the result is the same as the serial path.
+// When they return true, state holds the singles fixpoint of the givens left in samp.
+bool always_easy(std::vector<Weight> &samp, const Array9i &ans, Array9i state[] = nullptr);
+bool often_medium(std::vector<Weight> &samp, const Array9i &ans, Random &rng, ThreadPool *pool = nullptr,
+                  Array9i state[] = nullptr);
+bool usually_hard(std::vector<Weight> &samp, const Array9i &ans, Random &rng, ThreadPool *pool = nullptr,
+                  Array9i state[] = nullptr);
 
 void col_swap_block(int &r, int &c);
-bool _remove(Array9i board[], bool once);
+// digits is a mask, bit n for digit n
+bool _remove(Array9i board[], bool once, int digits = kAllDigits);
 bool col_circle_remove(Array9i board[], void (*fun)(int &, int &) = nullptr);
+bool circle_remove(Array9i board[]);
+
+// rates with a Scheduler of the builtin techniques, appending the level of each step to trace
+int rate(Array9i board[], std::vector<int> &trace);
 }  // namespace li
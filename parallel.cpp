@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#include "parallel.h"
+
+namespace li {
+ThreadPool::ThreadPool(int threads)
+    : _size(threads > 1 ? threads : 1), _fun(nullptr), _n(0), _next(0), _running(0), _round(0), _stop(false) {
+  for (int tid = 1; tid < _size; tid++) {
+    _workers.emplace_back(&ThreadPool::work, this, tid);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _stop = true;
+  }
+  _wake.notify_all();
+  for (auto &th : _workers) {
+    th.join();
+  }
+}
+
+void ThreadPool::drain(int tid) {
+  for (int idx = _next++; idx < _n; idx = _next++) {
+    (*_fun)(idx, tid);
+  }
+}
+
+void ThreadPool::work(int tid) {
+  unsigned seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(_mtx);
+      _wake.wait(lock, [&] { return _stop || _round != seen; });
+      if (_stop) return;
+      seen = _round;
+    }
+    drain(tid);
+    {
+      std::lock_guard<std::mutex> lock(_mtx);
+      if (--_running == 0) _done.notify_one();
+    }
+  }
+}
+
+void ThreadPool::parallel_for(int n, const std::function<void(int, int)> &fun) {
+  if (_size == 1 || n <= 1) {
+    for (int idx = 0; idx < n; idx++) fun(idx, 0);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _fun = &fun;
+    _n = n;
+    _next = 0;
+    _running = _size - 1;
+    _round++;
+  }
+  _wake.notify_all();
+  drain(0);
+  std::unique_lock<std::mutex> lock(_mtx);
+  _done.wait(lock, [&] { return _running == 0; });
+}
+}  // namespace li
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace li {
+// A fixed set of worker threads for data-parallel loops. The calling thread
+// takes part in every loop as thread 0, so ThreadPool(1) spawns nothing.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int threads);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int size() const { return _size; }
+  // Calls fun(idx, tid) once for every idx in [0, n) and returns when all are done.
+  void parallel_for(int n, const std::function<void(int, int)> &fun);
+
+ private:
+  void work(int tid);
+  void drain(int tid);
+
+  int _size;
+  std::vector<std::thread> _workers;
+  std::mutex _mtx;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+  const std::function<void(int, int)> *_fun;
+  int _n;
+  std::atomic<int> _next;
+  int _running;
+  unsigned _round;
+  bool _stop;
+};
+
+// A queue between threads holding at most cap items. push waits while it is
+// full, pop while it is empty; after close, push drops items and pop returns
+// false once the queue is drained.
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t cap) : _cap(cap), _closed(false) {}
+
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(_mtx);
+    _space.wait(lock, [&] { return _closed || _items.size() < _cap; });
+    if (_closed) return false;
+    _items.push_back(std::move(item));
+    _ready.notify_one();
+    return true;
+  }
+
+  bool pop(T &item) {
+    std::unique_lock<std::mutex> lock(_mtx);
+    _ready.wait(lock, [&] { return _closed || !_items.empty(); });
+    if (_items.empty()) return false;
+    item = std::move(_items.front());
+    _items.pop_front();
+    _space.notify_one();
+    return true;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _closed = true;
+    _ready.notify_all();
+    _space.notify_all();
+  }
+
+ private:
+  size_t _cap;
+  bool _closed;
+  std::deque<T> _items;
+  std::mutex _mtx;
+  std::condition_variable _ready;
+  std::condition_variable _space;
+};
+}  // namespace li
@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#include "pattern.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "solver.h"
+
+namespace li {
+namespace {
+int image(int pos, Symmetry sym) {
+  int r = pos / 9, c = pos % 9;
+  switch (sym) {
+    case Symmetry::rotational:
+      return (8 - r) * 9 + 8 - c;
+    case Symmetry::mirror:
+      return r * 9 + 8 - c;
+    case Symmetry::diagonal:
+      return c * 9 + r;
+    default:
+      return pos;
+  }
+}
+}  // namespace
+
+Givens random_givens(int clues, Symmetry sym, Random &rng) {
+  Givens mask;
+  clues = std::min(std::max(clues, 0), 81);
+  while (static_cast<int>(mask.count()) < clues) {
+    int pos = rng() % 81;
+    mask.set(pos);
+    mask.set(image(pos, sym));
+  }
+  return mask;
+}
+
+Givens parse_givens(const char *str) {
+  Givens mask;
+  for (int pos = 0; pos < 81 && str[pos]; pos++) {
+    if (str[pos] != '.' && str[pos] != '0') mask.set(pos);
+  }
+  return mask;
+}
+
+bool fit_givens(const Givens &mask, Array9i &puz, Array9i &ans, Random &rng, int stuck) {
+  std::vector<int> diff, given;
+  puz.fill(0);
+  for (int t = 0; t <= stuck;) {
+    Solver sol(puz);
+    sol.setLimit(1);
+    sol.setShuffle(&rng);
+    int cnt = sol.run();
+    const Array9i &one = sol.getSolution(0);
+    if (cnt == 1) {
+      ans = one;
+      for (int pos = 0; pos < 81; pos++) {
+        if (mask[pos]) puz(pos / 9, pos % 9) = one(pos / 9, pos % 9);
+      }
+      return true;
+    }
+    const Array9i &two = sol.getSolution(1);
+    diff.clear();
+    given.clear();
+    for (int pos = 0; pos < 81; pos++) {
+      int r = pos / 9, c = pos % 9;
+      if (puz(r, c)) {
+        given.push_back(pos);
+      } else if (mask[pos] && one(r, c) != two(r, c)) {
+        diff.push_back(pos);
+      }
+    }
+    if (diff.empty()) {
+      t++;
+      if (!given.empty()) {
+        int pos = given[rng() % given.size()];
+        puz(pos / 9, pos % 9) = 0;
+      }
+      continue;
+    }
+    int pos = diff[rng() % diff.size()];
+    puz(pos / 9, pos % 9) = one(pos / 9, pos % 9);
+  }
+  return false;
+}
+}  // namespace li
@@ -0,0 +1,37 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#pragma once
+
+#include <bitset>
+
+#include "config.h"
+
+namespace li {
+// cells that must hold the givens, bit r * 9 + c
+using Givens = std::bitset<81>;
+
+enum class Symmetry { none, rotational, mirror, diagonal };
+
+// about clues random cells, closed under the symmetry; clues is clamped to [0, 81]
+Givens random_givens(int clues, Symmetry sym, Random &rng);
+// 81 characters, a given wherever the character is not '.' or '0'
+Givens parse_givens(const char *str);
+
+// Looks for an answer whose values on exactly the masked cells make a unique
+// puzzle. Starting from no givens, it finds two solutions of the givens so far
+// and gives the first one's value on a masked cell where they differ, until a
+// single solution is left. If the two agree on every masked cell left, that
+// answer can't fit: it drops a random given and goes on, and gives up after
+// stuck such dead ends. Few masks under 28 givens fit at all.
+bool fit_givens(const Givens &mask, Array9i &puz, Array9i &ans, Random &rng, int stuck = 1000);
+}  // namespace li
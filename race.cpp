@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#include "race.h"
+
+namespace li {
+Difficulty strategy(int level) {
+  switch (level) {
+    case 1:
+      return Difficulty::easy;
+    case 5:
+      return Difficulty::hard;
+    default:
+      return Difficulty::medium;
+  }
+}
+
+Racer::Racer(int threads, unsigned seed) : _want(0), _stop(false) {
+  for (int i = 0; i < threads || i == 0; i++) {
+    _workers.emplace_back(&Racer::work, this, seed + i);
+  }
+}
+
+Racer::~Racer() {
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _stop = true;
+  }
+  _wake.notify_all();
+  for (auto &th : _workers) {
+    th.join();
+  }
+}
+
+void Racer::work(unsigned seed) {
+  Sudoku game(seed);
+  int want;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(_mtx);
+      _wake.wait(lock, [&] { return _stop || _want > 0; });
+      if (_stop) return;
+      want = _want;
+    }
+    int diff = game.newGame(strategy(want));
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (_kept[diff].size() < kKeep) {
+      _kept[diff].push_back(game.getGame());
+      if (diff == _want) _found.notify_one();
+    }
+  }
+}
+
+Game Racer::get(int level) {
+  if (level < 1 || level >= kLevel) return {Array9i::Zero(), Array9i::Zero(), 0};
+  std::lock_guard<std::mutex> call(_call);
+  std::unique_lock<std::mutex> lock(_mtx);
+  if (_kept[level].empty()) {
+    _want = level;
+    _wake.notify_all();
+    _found.wait(lock, [&] { return !_kept[level].empty(); });
+    _want = 0;
+  }
+  Game res = _kept[level].back();
+  _kept[level].pop_back();
+  return res;
+}
+
+int Racer::kept(int level) const {
+  if (level < 1 || level >= kLevel) return 0;
+  std::lock_guard<std::mutex> lock(_mtx);
+  return _kept[level].size();
+}
+}  // namespace li
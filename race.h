@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sudoku.h"
+
+namespace li {
+// the strategy of newGame most likely to produce a game of this level
+Difficulty strategy(int level);
+
+// Races newGame on several threads until one rates at the wanted level. The
+// other threads stop after their current attempt, and every game they still
+// produce is kept for later calls.
+class Racer {
+ public:
+  Racer(int threads, unsigned seed);
+  ~Racer();
+  Racer(const Racer &) = delete;
+  Racer &operator=(const Racer &) = delete;
+
+  // A game rated level. Levels outside [1, 5] are rejected at once with an
+  // empty game of diff 0.
+  Game get(int level);
+  int kept(int level) const;
+
+ private:
+  void work(unsigned seed);
+
+  static const int kLevel = 6;
+  static const int kKeep = 16;
+  std::vector<std::thread> _workers;
+  std::vector<Game> _kept[kLevel];
+  std::mutex _call;
+  mutable std::mutex _mtx;
+  std::condition_variable _wake;
+  std::condition_variable _found;
+  int _want;
+  bool _stop;
+};
+}  // namespace li
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#include "solver.h"
+
+#include <utility>
+
+#include "common.h"
+
+namespace li {
+namespace {
+inline int low_bit(uint16_t m) { return __builtin_ctz(m); }
+inline bool single_bit(uint16_t m) { return m && !(m & (m - 1)); }
+}  // namespace
+
+Solver::Solver(const Array9i &puz) : _valid(true), _rng(nullptr), cnt(0), limit(0) {
+  _sol[0].fill(0);
+  _sol[1].fill(0);
+  for (int pos = 0; pos < 81; pos++) {
+    _init.cand[pos] = kAllDigits;
+    _init.val[pos] = 0;
+  }
+  _init.left = 81;
+  for (int pos = 0; pos < 81 && _valid; pos++) {
+    int t = puz(pos / 9, pos % 9);
+    if (t > 0 && t < 10) {
+      _valid = assign(_init, pos, t);
+    }
+  }
+}
+
+bool Solver::assign(State &st, int pos, int num) {
+  uint16_t bit = 1 << num;
+  if (!(st.cand[pos] & bit)) return false;
+  st.cand[pos] = bit;
+  st.val[pos] = num;
+  st.left--;
+  for (int other : units.peer[pos]) {
+    if (st.cand[other] & bit) {
+      if (st.val[other]) return false;
+      st.cand[other] &= ~bit;
+      if (!st.cand[other]) return false;
+    }
+  }
+  return true;
+}
+
+bool Solver::propagate(State &st) {
+  bool modify = true;
+  while (modify && st.left > 0) {
+    modify = false;
+    for (int pos = 0; pos < 81; pos++) {
+      if (!st.val[pos] && single_bit(st.cand[pos])) {
+        if (!assign(st, pos, low_bit(st.cand[pos]))) return false;
+        modify = true;
+      }
+    }
+    for (auto &u : units.cell) {
+      uint16_t once = 0, twice = 0, fixed = 0;
+      for (int pos : u) {
+        uint16_t m = st.cand[pos];
+        if (st.val[pos]) {
+          fixed |= m;
+        } else {
+          twice |= once & m;
+          once |= m;
+        }
+      }
+      if ((once | fixed) != kAllDigits) return false;
+      for (uint16_t hidden = once & ~twice & ~fixed; hidden; hidden &= hidden - 1) {
+        int num = low_bit(hidden);
+        for (int pos : u) {
+          if (st.cand[pos] & (1 << num)) {
+            if (!assign(st, pos, num)) return false;
+            break;
+          }
+        }
+        modify = true;
+      }
+    }
+  }
+  return true;
+}
+
+void Solver::search(State &st) {
+  if (!propagate(st)) return;
+  if (st.left == 0) {
+    if (cnt < 2) {
+      for (int pos = 0; pos < 81; pos++) {
+        _sol[cnt](pos / 9, pos % 9) = st.val[pos];
+      }
+    }
+    cnt++;
+    return;
+  }
+  int best = -1, fewest = 10;
+  for (int pos = 0; pos < 81 && fewest > 2; pos++) {
+    if (!st.val[pos]) {
+      int n = __builtin_popcount(st.cand[pos]);
+      if (n < fewest) {
+        fewest = n;
+        best = pos;
+      }
+    }
+  }
+  int nums[9], n = 0;
+  for (uint16_t m = st.cand[best]; m; m &= m - 1) nums[n++] = low_bit(m);
+  if (_rng) {
+    for (int i = n - 1; i > 0; i--) std::swap(nums[i], nums[(*_rng)() % (i + 1)]);
+  }
+  for (int i = 0; i < n; i++) {
+    State next = st;
+    if (assign(next, best, nums[i])) {
+      search(next);
+      if (cnt > limit) return;
+    }
+  }
+}
+
+int Solver::run() {
+  cnt = 0;
+  if (_valid) {
+    State st = _init;
+    search(st);
+  }
+  return cnt;
+}
+
+bool solve(Array9i &grid) {
+  Solver sol(grid);
+  if (sol.run() == 0) return false;
+  grid = sol.getSolution();
+  return true;
+}
+}  // namespace li
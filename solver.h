@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "config.h"
+
+namespace li {
+// General solver for arbitrary input. Candidates are kept as bitmasks and
+// propagated with naked and hidden singles; when that stalls, it guesses on
+// the cell with the fewest candidates.
+class Solver {
+ public:
+  // blanks in puz are anything outside [1, 9]
+  explicit Solver(const Array9i &puz);
+  // stop once more than l solutions are found, like Puzzle
+  void setLimit(int l) { limit = l; }
+  // guess the digits of a cell in the order drawn from rng, so run() finds a
+  // random solution first; nullptr guesses in order
+  void setShuffle(Random *rng) { _rng = rng; }
+  int getCount() const { return cnt; }
+  // the i-th solution found, i < 2, valid when getCount() > i
+  const Array9i &getSolution(int i = 0) const { return _sol[i]; }
+
+  int run();
+
+ private:
+  struct State {
+    uint16_t cand[81];
+    uint8_t val[81];
+    int left;
+  };
+
+  static bool assign(State &st, int pos, int num);
+  static bool propagate(State &st);
+  void search(State &st);
+
+  State _init;
+  bool _valid;
+  Random *_rng;
+  Array9i _sol[2];
+  int cnt;
+  int limit;
+};
+
+// fills grid with its first solution, returns false when it has none
+bool solve(Array9i &grid);
+}  // namespace li
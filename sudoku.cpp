@@ -13,32 +13,50 @@
 #include "sudoku.h"
 
 #include <algorithm>
-#include <cstdlib>
 #include <ctime>
-#include <numeric>
 #include <vector>
 
 #include "common.h"
 #include "dfs.h"
 #include "impl.h"
+#include "parallel.h"
 
 namespace li {
-
-Sudoku::Sudoku() {
-  srand(time(0));
-  _diff = 1;
+namespace {
+bool fits(Difficulty dif, int diff) {
+  switch (dif) {
+    case Difficulty::easy:
+      return diff == 1;
+    case Difficulty::hard:
+      return diff == 5;
+    default:
+      return diff > 1 && diff < 5;
+  }
 }
+}  // namespace
+
+Sudoku::Sudoku() : _seeds(30), _probe(0), _rng(time(0)) { _diff = 1; }
+
+Sudoku::Sudoku(unsigned seed) : _seeds(30), _probe(0), _rng(seed) { _diff = 1; }
 
 Sudoku::~Sudoku() {
   // dtor
 }
 
+void Sudoku::setThreads(int n) {
+  if (n > 1) {
+    _pool.reset(new ThreadPool(n));
+  } else {
+    _pool.reset();
+  }
+}
+
 int Sudoku::newGame(Difficulty dif) {
   _ans.fill(0);
   int a[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
-  int r, c, num;
+  int r, c;
   for (int i = 0; i < 9; i += 3) {
-    std::random_shuffle(a, a + 9);
+    std::random_shuffle(a, a + 9, [this](int n) { return _rng() % n; });
     for (int j = 0; j < 9; j++) {
       r = i + j / 3;
       c = i + j % 3;
@@ -49,66 +67,84 @@ int Sudoku::newGame(Difficulty dif) {
   dfsGuess(pu);
 
   // create origin
-  std::vector<int> pool(81);
   std::vector<Weight> samp;
-  std::iota(pool.begin(), pool.end(), 0);
-  int times = 30;
-  int limit = pool.size();
-
-  _board[0].fill(0);
-  for (int i = 0; i < times; i++) {
-    int n = rand() % limit;
-    int pos = pool[n];
-    std::swap(pool[n], pool[--limit]);
-    r = pos / 9;
-    c = pos % 9;
-    _board[0](r, c) = _ans(r, c);
-    samp.push_back({r, c, 1});
-  }
-  init_note(_board);
+  build_origin(_ans, _seeds, _probe, _board, samp, _rng);
 
-  std::vector<Weight> vec;
-  while (_board[0].minCoeff() <= 0) {
-    fill_all_single(_board);
-    if (filter_notes(_board, vec)) {
-      auto it = max_element(vec.begin(), vec.end());
-      num = _ans(it->r, it->c);
-      setNum(it->r, it->c, num);
-      samp.push_back({it->r, it->c, 1});
-    }
-  }
-
-  // create hard
+  // create hard, keeping the singles fixpoint of the final givens
+  Array9i state[10];
+  bool saved = false;
   switch (dif) {
     case Difficulty::easy:
       always_easy(samp, _ans);
       break;
     case Difficulty::medium:
-      often_medium(samp, _ans);
+      saved = often_medium(samp, _ans, _rng, _pool.get(), state);
       break;
     case Difficulty::hard:
-      usually_hard(samp, _ans);
+      saved = usually_hard(samp, _ans, _rng, _pool.get(), state);
       break;
   }
 
-  // check diff
   _board[0].fill(0);
   for (auto &ele : samp) {
     _board[0](ele.r, ele.c) = _ans(ele.r, ele.c);
   }
   init_note(_board);
+  _puz = _board[0];
+
+  // check diff, going on from where the minimization stopped
   _diff = 1;
-  if (dif != Difficulty::easy) {
-    auto bak = _board[0];
-    while (fill_all_single(_board) > 0 || lineRemove() || circleRemove() || assumeRemove()) {
+  _trace.clear();
+  if (dif == Difficulty::easy) {
+    // erase_easy only drops givens that singles can put back
+    _trace.push_back(1);
+    return _diff;
+  }
+  if (saved) {
+    if ((state[0] > 0).count() > static_cast<int>(samp.size())) _trace.push_back(1);
+  } else {
+    for (int i = 0; i < 10; i++) {
+      state[i] = _board[i];
     }
-    if (_board[0].minCoeff() <= 0) _diff = 5;
-    _board[0] = bak;
-    init_note(_board);
   }
+  _diff = _sched.rate(state, _trace);
   return _diff;
 }
 
+int Sudoku::newGame(Difficulty dif, const Givens &mask, int tries) {
+  Array9i puz, ans, board[10], state[10];
+  std::vector<int> trace;
+  for (int i = 0; i < tries; i++) {
+    if (!fit_givens(mask, puz, ans, _rng)) continue;
+    board[0] = puz;
+    init_note(board);
+    for (int k = 0; k < 10; k++) {
+      state[k] = board[k];
+    }
+    trace.clear();
+    int diff = _sched.rate(state, trace);
+    if (!fits(dif, diff)) continue;
+    _puz = puz;
+    _ans = ans;
+    _diff = diff;
+    _trace.swap(trace);
+    for (int k = 0; k < 10; k++) {
+      _board[k] = board[k];
+    }
+    return _diff;
+  }
+  return 0;
+}
+
+void Sudoku::loadGame(const Game &game) {
+  _puz = game.puzzle;
+  _ans = game.answer;
+  _diff = game.diff;
+  _trace.clear();
+  _board[0] = _puz;
+  init_note(_board);
+}
+
 bool Sudoku::getNum(int r, int c, int &num) const {
   int n = _board[0](r, c);
   if (n >= 1 && n <= 9) {
@@ -148,8 +184,7 @@ bool Sudoku::lineRemove() {
 }
 
 bool Sudoku::circleRemove() {
-  bool modify =
-      col_circle_remove(_board) | col_circle_remove(_board, std::swap<int>) | col_circle_remove(_board, col_swap_block);
+  bool modify = circle_remove(_board);
   if (modify && _diff < 3) _diff = 3;
   return modify;
 }
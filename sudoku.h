@@ -12,16 +12,49 @@
  */
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "config.h"
+#include "pattern.h"
+#include "technique.h"
 
 namespace li {
+class ThreadPool;
+
 enum class Difficulty { easy = 1, medium, hard = 5 };
+
+// a generated game detached from the Sudoku that made it
+struct Game {
+  Array9i puzzle;
+  Array9i answer;
+  int diff;
+};
+
 class Sudoku {
  public:
   Sudoku();
+  explicit Sudoku(unsigned seed);
   ~Sudoku();
 
+  // new games from here on are those Sudoku(seed) would make
+  void setSeed(unsigned seed) { _rng.seed(seed); }
+
+  // evaluate clues of medium/hard games on n threads, same games as n = 1
+  void setThreads(int n);
+
+  // origin of new games: seeds random givens (30 by default), then givens
+  // picked by probing the probe fullest cells (0: just the fullest), see build_origin
+  void setOrigin(int seeds, int probe) {
+    _seeds = seeds;
+    _probe = probe;
+  }
+
   int newGame(Difficulty dif);
+  // A game whose givens are exactly the masked cells and whose rating fits dif
+  // (1 for easy, 5 for hard, the rest medium). Returns 0 and keeps the current
+  // game if none of tries fitted answers rated right.
+  int newGame(Difficulty dif, const Givens &mask, int tries = 100);
   bool getNum(int r, int c, int &num) const;
   void setNum(int r, int c, int num);
   void flipNote(int r, int c, int num);
@@ -32,10 +65,23 @@ class Sudoku {
   bool assumeRemove();
 
   int getDiff() const { return _diff; }
+  // level of each technique step taken while rating the last new game
+  const std::vector<int> &getTrace() const { return _trace; }
+  // rates new games; turn on its timing to see where rating spends its time
+  Scheduler &getScheduler() { return _sched; }
+  Game getGame() const { return {_puz, _ans, _diff}; }
+  void loadGame(const Game &game);
 
  private:
   int _diff;
+  int _seeds;
+  int _probe;
+  Random _rng;
   Array9i _board[10];
+  Array9i _puz;
+  std::vector<int> _trace;
   Array9i _ans;
+  std::unique_ptr<ThreadPool> _pool;
+  Scheduler _sched;
 };
 }  // namespace li
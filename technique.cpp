@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#include "technique.h"
+
+#include <chrono>
+
+#include "common.h"
+#include "impl.h"
+
+namespace li {
+namespace {
+bool singles(Array9i board[], int) { return fill_all_single(board) > 0; }
+bool line(Array9i board[], int digits) { return _remove(board, true, digits); }
+bool circle(Array9i board[], int) { return circle_remove(board); }
+bool assume(Array9i board[], int digits) { return _remove(board, false, digits); }
+
+// digits whose candidates or placed cells differ between the two boards
+int changed_digits(const Array9i board[], const Array9i last[]) {
+  int res = 0;
+  for (int n = 1; n < 10; n++) {
+    if ((board[n] != last[n]).any() || ((board[0] == n) != (last[0] == n)).any()) res |= 1 << n;
+  }
+  return res;
+}
+}  // namespace
+
+Scheduler::Scheduler() : _timing(false) {
+  // costs are rough time per call relative to singles, see bench_rate
+  add({"singles", 1, 1, singles});
+  add({"line", 2, 2, line});
+  add({"circle", 3, 10, circle});
+  add({"assume", 4, 4, assume});
+}
+
+void Scheduler::add(const Technique &tech) {
+  size_t i = _techs.size();
+  while (i > 0 && (_techs[i - 1].level > tech.level ||
+                   (_techs[i - 1].level == tech.level && _techs[i - 1].cost > tech.cost))) {
+    i--;
+  }
+  _techs.insert(_techs.begin() + i, tech);
+  _stats.insert(_stats.begin() + i, TechniqueStat());
+}
+
+void Scheduler::clearStats() {
+  for (auto &stat : _stats) stat = TechniqueStat();
+}
+
+int Scheduler::rate(Array9i board[], std::vector<int> &trace) {
+  const size_t size = _techs.size();
+  std::vector<int> clean(size, 0);
+  Array9i last[10];
+  for (int i = 0; i < 10; i++) last[i] = board[i];
+  int diff = 1;
+  while (true) {
+    size_t i = 0;
+    for (; i < size; i++) {
+      int digits = kAllDigits & ~clean[i];
+      _stats[i].calls++;
+      bool hit;
+      if (_timing) {
+        auto t1 = std::chrono::steady_clock::now();
+        hit = _techs[i].kernel(board, digits);
+        std::chrono::duration<double> t2 = std::chrono::steady_clock::now() - t1;
+        _stats[i].seconds += t2.count();
+      } else {
+        hit = _techs[i].kernel(board, digits);
+      }
+      if (hit) break;
+      clean[i] |= digits;
+    }
+    if (i == size) break;
+    _stats[i].hits++;
+    int level = _techs[i].level;
+    trace.push_back(level);
+    if (diff < level) diff = level;
+    int digits = changed_digits(board, last);
+    for (auto &bits : clean) bits &= ~digits;
+    for (int k = 0; k < 10; k++) last[k] = board[k];
+  }
+  if (board[0].minCoeff() <= 0) diff = 5;
+  return diff;
+}
+}  // namespace li
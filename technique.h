@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2024 Zhongxian Li
+ * quick sudoku is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "config.h"
+
+namespace li {
+// A kernel tries the technique once and returns true if it changed the board.
+// digits holds the digits changed since the kernel last found nothing; a kernel
+// that handles each digit on its own may look at those only, others ignore it.
+struct Technique {
+  const char *name;
+  int level;
+  int cost;
+  bool (*kernel)(Array9i board[], int digits);
+};
+
+struct TechniqueStat {
+  long calls = 0;
+  long hits = 0;
+  double seconds = 0;
+};
+
+// Rates a board by running the techniques from the lowest level up, the
+// cheapest first within a level, and starting over after every change. Cost
+// can't reorder levels: assume is cheaper than circle, but running it first
+// would rate the same board higher. After the line and assume kernels find
+// nothing, their next calls only look at the digits changed since.
+class Scheduler {
+ public:
+  // registers singles, line, circle and assume
+  Scheduler();
+
+  // keeps the techniques ordered by level then cost, after those equal to it
+  void add(const Technique &tech);
+  // time every kernel call; off by default
+  void setTiming(bool on) { _timing = on; }
+  void clearStats();
+
+  // appends the level of each step to trace, returns 5 if the board is not solved
+  int rate(Array9i board[], std::vector<int> &trace);
+
+  const std::vector<Technique> &techniques() const { return _techs; }
+  const std::vector<TechniqueStat> &stats() const { return _stats; }
+
+ private:
+  std::vector<Technique> _techs;
+  std::vector<TechniqueStat> _stats;
+  bool _timing;
+};
+}  // namespace li
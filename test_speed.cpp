@@ -1,7 +1,9 @@
-#include <ctime>
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <vector>
 
+#include "race.h"
 #include "sudoku.h"
 
 const int times = 1000;
@@ -11,22 +13,65 @@ constexpr double kilo = 1000.0;
 using li::Difficulty;
 
 void print(li::Sudoku &game, Difficulty dif, const std::string &s) {
-  std::clock_t t1, t2;
   int a[kLevel] = {0};
-  t1 = clock();
+  auto t1 = std::chrono::steady_clock::now();
   for (int i = 0; i < times; i++) {
     a[game.newGame(dif)]++;
   }
-  t2 = clock() - t1;
-  std::cout << s << ": " << kilo * t2 / CLOCKS_PER_SEC << "ms" << std::endl;
+  std::chrono::duration<double> t2 = std::chrono::steady_clock::now() - t1;
+  std::cout << s << ": " << kilo * t2.count() << "ms" << std::endl;
   for (int i = 1; i < kLevel; i++) std::cout << a[i] << " ";
   std::cout << std::endl << std::endl;
 }
 
+void race(int threads, int level) {
+  li::Racer racer(threads, 1);
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < times / 10; i++) {
+    racer.get(level);
+  }
+  std::chrono::duration<double> t2 = std::chrono::steady_clock::now() - t1;
+  std::cout << "race level " << level << ", " << threads << " threads: " << kilo * t2.count() / (times / 10)
+            << "ms each" << std::endl;
+}
+
+std::vector<li::Game> games(li::Sudoku &game, int n) {
+  std::vector<li::Game> res;
+  for (int i = 0; i < n; i++) {
+    game.newGame(i % 2 ? Difficulty::hard : Difficulty::medium);
+    res.push_back(game.getGame());
+  }
+  return res;
+}
+
+// the same seed must give the same games whatever the number of threads
+int same(int threads) {
+  li::Sudoku one(1);
+  auto expect = games(one, times / 10);
+  li::Sudoku par(1);
+  par.setThreads(threads);
+  auto got = games(par, times / 10);
+  int differ = 0;
+  for (size_t i = 0; i < got.size(); i++) {
+    differ += (got[i].puzzle != expect[i].puzzle).any() || got[i].diff != expect[i].diff;
+  }
+  std::cout << threads << " threads vs 1: " << differ << " differ" << std::endl << std::endl;
+  return differ;
+}
+
 int main() {
   li::Sudoku game;
 
   print(game, Difficulty::easy, "easy");
   print(game, Difficulty::medium, "medium");
   print(game, Difficulty::hard, "hard");
+
+  li::Sudoku par;
+  par.setThreads(4);
+  print(par, Difficulty::hard, "hard, 4 threads");
+  int differ = same(4);
+
+  race(1, 3);
+  race(4, 3);
+  return differ > 0;
 }